@@ -0,0 +1,147 @@
+#ifndef ARUCO_LAB_H
+#define ARUCO_LAB_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Symbol export. ARUCO_LAB_SHARED is set for users of the shared library,
+// ARUCO_LAB_BUILD only while building it.
+#if defined(_WIN32)
+#if defined(ARUCO_LAB_SHARED) && defined(ARUCO_LAB_BUILD)
+#define ARUCO_LAB_API __declspec(dllexport)
+#elif defined(ARUCO_LAB_SHARED)
+#define ARUCO_LAB_API __declspec(dllimport)
+#else
+#define ARUCO_LAB_API
+#endif
+#elif defined(__GNUC__)
+#define ARUCO_LAB_API __attribute__((visibility("default")))
+#else
+#define ARUCO_LAB_API
+#endif
+
+// Version of the C interface, bumped only on incompatible changes.
+// CMake reads it from here for the shared library's SOVERSION.
+#define ARUCO_LAB_API_VERSION 1
+
+// Number of distortion coefficients (k1, k2, p1, p2, k3)
+#define ARUCO_LAB_N_DIST_COEFFS 5
+
+// Return codes
+typedef enum {
+    ARUCO_LAB_OK = 0,
+    ARUCO_LAB_ERR_INVALID_ARGUMENT = -1,
+    ARUCO_LAB_ERR_UNKNOWN_DICTIONARY = -2,
+    ARUCO_LAB_ERR_BUFFER_TOO_SMALL = -3,
+    ARUCO_LAB_ERR_IO = -4,
+    ARUCO_LAB_ERR_INTERNAL = -5,
+    ARUCO_LAB_ERR_NOT_READY = -6,
+    ARUCO_LAB_ERR_NO_SOLUTION = -7
+} aruco_lab_status;
+
+// Caller-owned 8-bit image buffer (1 or 3 channels, row stride in bytes).
+// The library reads and writes it in place and never keeps a reference.
+typedef struct {
+    unsigned char* data;
+    int width;
+    int height;
+    int channels;
+    size_t stride;
+} aruco_lab_image;
+
+// Intrinsic camera parameters (row-major 3x3 camera matrix)
+typedef struct {
+    double cameraMatrix[9];
+    double distCoeffs[ARUCO_LAB_N_DIST_COEFFS];
+} aruco_lab_camera;
+
+// Live calibration estimate
+typedef struct {
+    aruco_lab_camera camera;
+    double repError;
+    int nViews; // views matched so far
+    int converged; // non-zero once error and focal length have settled
+} aruco_lab_calibration;
+
+// Detector handle, reused across frames
+typedef struct aruco_lab_detector aruco_lab_detector;
+
+// Incremental calibrator handle, owns a background worker thread
+typedef struct aruco_lab_calibrator aruco_lab_calibrator;
+
+ARUCO_LAB_API int aruco_lab_api_version(void);
+
+// Map a dictionary name (e.g. "DICT_ARUCO_ORIGINAL") to its id
+ARUCO_LAB_API int aruco_lab_dictionary_from_name(const char* name, int* dictId);
+
+// Generation. The output image must be single channel and exactly
+// (markerLength + 2 * frameSize) px square for a marker, and
+// (markerLength + separation) * rows by (markerLength + separation) * columns
+// px for a board; any other size is ERR_INVALID_ARGUMENT.
+ARUCO_LAB_API int aruco_lab_generate_marker(int dictId, int markerId, int markerLength,
+                                            int frameSize, aruco_lab_image* out);
+ARUCO_LAB_API int aruco_lab_generate_board(int dictId, int rows, int columns, int markerLength,
+                                           int separation, aruco_lab_image* out);
+
+// Detection. Corners are written as 8 floats (4 x/y pairs) per marker;
+// ids and corners must hold at least maxMarkers entries. *nMarkers is 0
+// on failure and maxMarkers with ERR_BUFFER_TOO_SMALL on truncation.
+ARUCO_LAB_API aruco_lab_detector* aruco_lab_detector_create(int dictId);
+ARUCO_LAB_API void aruco_lab_detector_destroy(aruco_lab_detector* detector);
+ARUCO_LAB_API int aruco_lab_detect_markers(aruco_lab_detector* detector, const aruco_lab_image* image,
+                                           int maxMarkers, int* ids, float* corners, int* nMarkers);
+
+// Calibration from a grid board. ids and corners hold the detections of all
+// frames back to back, nMarkersPerFrame[i] gives the count of frame i.
+ARUCO_LAB_API int aruco_lab_calibrate_board(int dictId, int rows, int columns, double markerLength,
+                                            double separation, int nFrames, const int* nMarkersPerFrame,
+                                            const int* ids, const float* corners,
+                                            int imageWidth, int imageHeight,
+                                            aruco_lab_camera* camera, double* repError);
+
+// Incremental calibration from a grid board. add_view queues one view
+// (copied) and returns at once; a background thread matches it and
+// re-estimates the intrinsics over at most 10 views spread over the
+// capture, warm-started from the previous estimate. estimate returns the
+// latest result without blocking (ERR_NOT_READY if none yet), finish waits
+// for queued views and runs one solve over all of them.
+ARUCO_LAB_API aruco_lab_calibrator* aruco_lab_calibrator_create(int dictId, int rows, int columns,
+                                                                double markerLength, double separation,
+                                                                int imageWidth, int imageHeight);
+ARUCO_LAB_API void aruco_lab_calibrator_destroy(aruco_lab_calibrator* calibrator);
+ARUCO_LAB_API int aruco_lab_calibrator_add_view(aruco_lab_calibrator* calibrator, int nMarkers,
+                                                const int* ids, const float* corners);
+ARUCO_LAB_API int aruco_lab_calibrator_estimate(aruco_lab_calibrator* calibrator, aruco_lab_calibration* estimate);
+ARUCO_LAB_API int aruco_lab_calibrator_finish(aruco_lab_calibrator* calibrator, aruco_lab_calibration* estimate);
+
+ARUCO_LAB_API int aruco_lab_camera_load(const char* filename, aruco_lab_camera* camera);
+ARUCO_LAB_API int aruco_lab_camera_save(const char* filename, const aruco_lab_camera* camera, double repError);
+
+// Pose of a single marker (corners as returned by detection). Returns
+// ERR_NO_SOLUTION, with rvec/tvec unspecified, if no pose was found.
+ARUCO_LAB_API int aruco_lab_estimate_pose(const float* corners, double markerLength,
+                                          const aruco_lab_camera* camera, double* rvec, double* tvec);
+
+// Overlays drawn in place on a caller-owned image. Marker outlines (and
+// the first-corner boxes) of all markers are each drawn in one call.
+ARUCO_LAB_API int aruco_lab_draw_markers(aruco_lab_image* image, int nMarkers,
+                                         const int* ids, const float* corners);
+ARUCO_LAB_API int aruco_lab_draw_axes(aruco_lab_image* image, const aruco_lab_camera* camera,
+                                      const double* rvec, const double* tvec, double length);
+// Axes for several poses (3 doubles each in rvecs/tvecs), one draw per axis colour
+ARUCO_LAB_API int aruco_lab_draw_axes_batch(aruco_lab_image* image, const aruco_lab_camera* camera, int nAxes,
+                                            const double* rvecs, const double* tvecs, double length);
+ARUCO_LAB_API int aruco_lab_draw_cube(aruco_lab_image* image, const aruco_lab_camera* camera,
+                                      const double* rvec, const double* tvec, double markerLength);
+// Cubes for several poses (3 doubles each in rvecs/tvecs), all edges in one draw
+ARUCO_LAB_API int aruco_lab_draw_cubes(aruco_lab_image* image, const aruco_lab_camera* camera, int nCubes,
+                                       const double* rvecs, const double* tvecs, double markerLength);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // ARUCO_LAB_H
@@ -0,0 +1,19 @@
+#ifndef ARUCO_LAB_CV_HPP
+#define ARUCO_LAB_CV_HPP
+
+#include "aruco_lab.h"
+#include "opencv2/core.hpp"
+
+// View a cv::Mat as a library image (shares the pixel buffer, no copy).
+// Non 8-bit Mats get a null buffer, which the library rejects.
+inline aruco_lab_image aruco_lab_wrap(cv::Mat& mat) {
+    aruco_lab_image image;
+    image.data = mat.depth() == CV_8U ? mat.data : nullptr;
+    image.width = mat.cols;
+    image.height = mat.rows;
+    image.channels = mat.channels();
+    image.stride = mat.step[0];
+    return image;
+}
+
+#endif // ARUCO_LAB_CV_HPP
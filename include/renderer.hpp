@@ -0,0 +1,74 @@
+#ifndef RENDERER_HPP
+#define RENDERER_HPP
+
+#include "opencv2/core.hpp"
+#include "opencv2/videoio.hpp"
+#include <atomic>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Frame handed from the detection thread to the renderer. The overlay is
+// drawn on the renderer's thread, only for frames that are actually shown.
+struct RenderFrame {
+    cv::Mat image;
+    std::function<void(cv::Mat&)> overlay;
+};
+
+// Displays the latest submitted frame at a fixed refresh rate, independent of
+// how fast frames are produced. Frames submitted between two refreshes are
+// dropped. run() and runWith() must be called from the main (GUI) thread.
+class Renderer {
+public:
+    explicit Renderer(const std::string& windowName, double refreshRate = 30.0);
+
+    // Capture on a worker thread, turn each frame into a RenderFrame with
+    // process (also on the worker) and display until ESC or end of capture
+    void runWith(cv::VideoCapture& capture, const std::function<RenderFrame(cv::Mat&)>& process);
+
+    // Called from the producer thread, never blocks on the display
+    void submit(RenderFrame frame);
+
+    // Display loop, returns on ESC or after stop()
+    void run();
+    void stop();
+    bool running() const;
+
+private:
+    std::string windowName;
+    int periodMs;
+
+    std::mutex latestMutex;
+    RenderFrame latest;
+    bool hasLatest = false;
+
+    std::atomic<bool> active;
+};
+
+// Hershey text drawn from glyphs rasterized once per character, so changing
+// labels (e.g. live coordinates) are composed by masked copies instead of
+// being re-rasterized stroke by stroke every frame. Not thread-safe; use it
+// from the thread that draws.
+class TextCache {
+public:
+    TextCache(int fontFace, double fontScale, int thickness);
+
+    void draw(cv::Mat& image, const std::string& text, cv::Point origin, const cv::Scalar& color);
+
+private:
+    struct Glyph {
+        cv::Mat mask; // 255 where the glyph is drawn
+        cv::Point origin; // text origin inside the mask
+        int advance;
+    };
+
+    const Glyph& glyph(char c);
+
+    int fontFace;
+    double fontScale;
+    int thickness;
+    std::unordered_map<char, Glyph> glyphs;
+};
+
+#endif // RENDERER_HPP
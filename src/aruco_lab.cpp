@@ -0,0 +1,735 @@
+#include "aruco_lab.h"
+#include "opencv2/imgproc.hpp"
+#include "opencv2/aruco.hpp"
+#include "opencv2/calib3d.hpp"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unordered_map>
+
+using namespace std;
+
+struct aruco_lab_detector {
+    cv::aruco::ArucoDetector detector;
+};
+
+namespace {
+
+// Map dictionary names to their corresponding enum values
+const unordered_map<string, int>& dictMap() {
+    static const unordered_map<string, int> map = {
+        {"DICT_4X4_50", cv::aruco::DICT_4X4_50},
+        {"DICT_4X4_100", cv::aruco::DICT_4X4_100},
+        {"DICT_4X4_250", cv::aruco::DICT_4X4_250},
+        {"DICT_4X4_1000", cv::aruco::DICT_4X4_1000},
+        {"DICT_5X5_50", cv::aruco::DICT_5X5_50},
+        {"DICT_5X5_100", cv::aruco::DICT_5X5_100},
+        {"DICT_5X5_250", cv::aruco::DICT_5X5_250},
+        {"DICT_5X5_1000", cv::aruco::DICT_5X5_1000},
+        {"DICT_6X6_50", cv::aruco::DICT_6X6_50},
+        {"DICT_6X6_100", cv::aruco::DICT_6X6_100},
+        {"DICT_6X6_250", cv::aruco::DICT_6X6_250},
+        {"DICT_6X6_1000", cv::aruco::DICT_6X6_1000},
+        {"DICT_7X7_50", cv::aruco::DICT_7X7_50},
+        {"DICT_7X7_100", cv::aruco::DICT_7X7_100},
+        {"DICT_7X7_250", cv::aruco::DICT_7X7_250},
+        {"DICT_7X7_1000", cv::aruco::DICT_7X7_1000},
+        {"DICT_ARUCO_ORIGINAL", cv::aruco::DICT_ARUCO_ORIGINAL}
+    };
+    return map;
+}
+
+bool validDictionary(int dictId) {
+    return dictId >= cv::aruco::DICT_4X4_50 && dictId <= cv::aruco::DICT_ARUCO_ORIGINAL;
+}
+
+// Wrap a caller-owned buffer in a Mat header (no copy)
+bool wrapImage(const aruco_lab_image* image, cv::Mat& mat) {
+    if (image == nullptr || image->data == nullptr || image->width <= 0 || image->height <= 0) {
+        return false;
+    }
+    if (image->channels != 1 && image->channels != 3) {
+        return false;
+    }
+    size_t minStride = static_cast<size_t>(image->width) * image->channels;
+    size_t stride = image->stride == 0 ? minStride : image->stride;
+    if (stride < minStride) {
+        return false;
+    }
+    mat = cv::Mat(image->height, image->width, CV_8UC(image->channels), image->data, stride);
+    return true;
+}
+
+// Camera parameters as Mat headers over the caller's struct (no copy)
+cv::Mat cameraMatrixOf(const aruco_lab_camera* camera) {
+    return cv::Mat(3, 3, CV_64F, const_cast<double*>(camera->cameraMatrix));
+}
+
+cv::Mat distCoeffsOf(const aruco_lab_camera* camera) {
+    return cv::Mat(1, ARUCO_LAB_N_DIST_COEFFS, CV_64F, const_cast<double*>(camera->distCoeffs));
+}
+
+// Unpack 8 floats per marker into the layout expected by the aruco module
+void unpackCorners(const float* corners, int nMarkers, vector<vector<cv::Point2f>>& markerCorners) {
+    markerCorners.resize(nMarkers);
+    for (int i = 0; i < nMarkers; i++) {
+        const cv::Point2f* pts = reinterpret_cast<const cv::Point2f*>(corners + 8 * i);
+        markerCorners[i].assign(pts, pts + 4);
+    }
+}
+
+// Marker corners in the marker frame, in detection order
+cv::Mat markerObjectPoints(double markerLength) {
+    float half = static_cast<float>(markerLength / 2.0);
+    cv::Mat objPoints(4, 1, CV_32FC3);
+    objPoints.ptr<cv::Vec3f>(0)[0] = cv::Vec3f(-half, half, 0);
+    objPoints.ptr<cv::Vec3f>(0)[1] = cv::Vec3f(half, half, 0);
+    objPoints.ptr<cv::Vec3f>(0)[2] = cv::Vec3f(half, -half, 0);
+    objPoints.ptr<cv::Vec3f>(0)[3] = cv::Vec3f(-half, -half, 0);
+    return objPoints;
+}
+
+// Run f and translate any exception into a status code (nothing may cross the C ABI)
+template <typename F>
+int guarded(F f) {
+    try {
+        return f();
+    } catch (...) {
+        return ARUCO_LAB_ERR_INTERNAL;
+    }
+}
+
+} // namespace
+
+struct aruco_lab_calibrator {
+    // One captured view, copied out of the caller's buffers
+    struct View {
+        vector<int> ids;
+        vector<vector<cv::Point2f>> corners;
+    };
+
+    aruco_lab_calibrator(const cv::aruco::GridBoard& board, cv::Size size)
+        : gridboard(board), imgSize(size) {}
+
+    cv::aruco::GridBoard gridboard;
+    cv::Size imgSize;
+
+    // Shared with the caller, guarded by stateMutex
+    mutex stateMutex;
+    condition_variable wake, idle;
+    deque<View> pending;
+    bool busy = false;
+    bool stop = false;
+    bool hasEstimate = false;
+    aruco_lab_calibration estimate = {};
+
+    // Owned by whoever set busy (the worker, or finish)
+    vector<cv::Mat> objectPoints, imagePoints;
+    cv::Mat cameraMatrix, distCoeffs;
+    thread worker;
+
+    // Live updates solve over at most this many views, so their cost does
+    // not grow with the number of captures; finish uses all of them
+    static const int maxLiveViews = 10;
+
+    // Re-estimate intrinsics over the given views. After the first solve the
+    // previous estimate is used as initial guess, which needs far fewer
+    // iterations than a cold start.
+    bool solve(const vector<cv::Mat>& objPoints, const vector<cv::Mat>& imgPoints,
+               const cv::TermCriteria& warmCriteria, aruco_lab_calibration& result) {
+        int flags = 0;
+        cv::TermCriteria criteria(cv::TermCriteria::COUNT + cv::TermCriteria::EPS, 30, DBL_EPSILON);
+        cv::Mat guessMatrix, guessCoeffs;
+        if (cameraMatrix.empty()) {
+            guessMatrix = cv::Mat::eye(3, 3, CV_64F);
+        } else {
+            guessMatrix = cameraMatrix.clone();
+            guessCoeffs = distCoeffs.clone();
+            flags |= cv::CALIB_USE_INTRINSIC_GUESS;
+            criteria = warmCriteria;
+        }
+
+        try {
+            vector<cv::Mat> rvecs, tvecs;
+            result.repError = cv::calibrateCamera(objPoints, imgPoints, imgSize, guessMatrix, guessCoeffs,
+                                                  rvecs, tvecs, flags, criteria);
+            guessMatrix.copyTo(cameraMatrixOf(&result.camera));
+            guessCoeffs.reshape(1, 1).colRange(0, ARUCO_LAB_N_DIST_COEFFS).copyTo(distCoeffsOf(&result.camera));
+        } catch (...) {
+            // Too few or degenerate views so far, keep the previous estimate
+            return false;
+        }
+        cameraMatrix = guessMatrix;
+        distCoeffs = guessCoeffs;
+        result.nViews = static_cast<int>(objectPoints.size());
+        return true;
+    }
+
+    // Views spread evenly over the whole capture (newest always included),
+    // so the live subset keeps the variety of poses calibration needs
+    void liveSubset(vector<cv::Mat>& objPoints, vector<cv::Mat>& imgPoints) const {
+        size_t n = objectPoints.size();
+        if (n <= static_cast<size_t>(maxLiveViews)) {
+            objPoints = objectPoints;
+            imgPoints = imagePoints;
+            return;
+        }
+        for (int i = 0; i < maxLiveViews; i++) {
+            size_t k = (n - 1) * i / (maxLiveViews - 1);
+            objPoints.push_back(objectPoints[k]);
+            imgPoints.push_back(imagePoints[k]);
+        }
+    }
+
+    // Converged once error and focal lengths change by less than 1% between
+    // consecutive estimates, with a few views in
+    static bool hasConverged(const aruco_lab_calibration& previous, const aruco_lab_calibration& current) {
+        const double tolerance = 0.01;
+        const int minViews = 4;
+        if (current.nViews < minViews) {
+            return false;
+        }
+        double dError = fabs(current.repError - previous.repError) / max(current.repError, 1e-9);
+        double dFx = fabs(current.camera.cameraMatrix[0] - previous.camera.cameraMatrix[0]) / fabs(current.camera.cameraMatrix[0]);
+        double dFy = fabs(current.camera.cameraMatrix[4] - previous.camera.cameraMatrix[4]) / fabs(current.camera.cameraMatrix[4]);
+        return dError < tolerance && dFx < tolerance && dFy < tolerance;
+    }
+
+    // Store a new estimate (stateMutex held)
+    void publish(aruco_lab_calibration& result) {
+        result.converged = hasEstimate && hasConverged(estimate, result);
+        estimate = result;
+        hasEstimate = true;
+    }
+
+    void run() {
+        // Warm-started solves start near the optimum, so cap them early
+        const cv::TermCriteria warmCriteria(cv::TermCriteria::COUNT + cv::TermCriteria::EPS, 10, 1e-6);
+
+        unique_lock<mutex> guard(stateMutex);
+        while (true) {
+            wake.wait(guard, [this]() { return stop || (!pending.empty() && !busy); });
+            if (stop) {
+                break;
+            }
+
+            // Take every queued view so a backlog is folded into one solve
+            deque<View> views;
+            views.swap(pending);
+            busy = true;
+            guard.unlock();
+
+            bool added = false;
+            for (const View& view : views) {
+                cv::Mat currentImgPoints, currentObjPoints;
+                try {
+                    gridboard.matchImagePoints(view.corners, view.ids, currentObjPoints, currentImgPoints);
+                } catch (...) {
+                    continue;
+                }
+                if (currentImgPoints.total() > 0 && currentObjPoints.total() > 0) {
+                    imagePoints.push_back(currentImgPoints);
+                    objectPoints.push_back(currentObjPoints);
+                    added = true;
+                }
+            }
+
+            aruco_lab_calibration result = {};
+            bool solved = false;
+            if (added) {
+                vector<cv::Mat> objPoints, imgPoints;
+                liveSubset(objPoints, imgPoints);
+                solved = solve(objPoints, imgPoints, warmCriteria, result);
+            }
+
+            guard.lock();
+            if (solved) {
+                publish(result);
+            }
+            busy = false;
+            idle.notify_all();
+        }
+    }
+};
+
+extern "C" {
+
+int aruco_lab_api_version(void) {
+    return ARUCO_LAB_API_VERSION;
+}
+
+int aruco_lab_dictionary_from_name(const char* name, int* dictId) {
+    if (name == nullptr || dictId == nullptr) {
+        return ARUCO_LAB_ERR_INVALID_ARGUMENT;
+    }
+    return guarded([&]() {
+        auto it = dictMap().find(name);
+        if (it == dictMap().end()) {
+            return static_cast<int>(ARUCO_LAB_ERR_UNKNOWN_DICTIONARY);
+        }
+        *dictId = it->second;
+        return static_cast<int>(ARUCO_LAB_OK);
+    });
+}
+
+int aruco_lab_generate_marker(int dictId, int markerId, int markerLength, int frameSize, aruco_lab_image* out) {
+    cv::Mat canvas;
+    if (!validDictionary(dictId)) {
+        return ARUCO_LAB_ERR_UNKNOWN_DICTIONARY;
+    }
+    if (markerLength <= 0 || frameSize < 0 || !wrapImage(out, canvas) || canvas.channels() != 1) {
+        return ARUCO_LAB_ERR_INVALID_ARGUMENT;
+    }
+    if (canvas.rows != markerLength + 2 * frameSize || canvas.cols != markerLength + 2 * frameSize) {
+        return ARUCO_LAB_ERR_INVALID_ARGUMENT;
+    }
+    return guarded([&]() {
+        cv::aruco::Dictionary dictionary = cv::aruco::getPredefinedDictionary(dictId);
+
+        // White frame, then the marker rendered straight into the centre
+        canvas.setTo(cv::Scalar(255));
+        cv::Mat roi = canvas(cv::Rect(frameSize, frameSize, markerLength, markerLength));
+        cv::aruco::generateImageMarker(dictionary, markerId, markerLength, roi, 1);
+        return static_cast<int>(ARUCO_LAB_OK);
+    });
+}
+
+int aruco_lab_generate_board(int dictId, int rows, int columns, int markerLength, int separation, aruco_lab_image* out) {
+    cv::Mat canvas;
+    if (!validDictionary(dictId)) {
+        return ARUCO_LAB_ERR_UNKNOWN_DICTIONARY;
+    }
+    if (rows <= 0 || columns <= 0 || markerLength <= 0 || separation < 0 || !wrapImage(out, canvas) || canvas.channels() != 1) {
+        return ARUCO_LAB_ERR_INVALID_ARGUMENT;
+    }
+    if (canvas.rows != (markerLength + separation) * rows || canvas.cols != (markerLength + separation) * columns) {
+        return ARUCO_LAB_ERR_INVALID_ARGUMENT;
+    }
+    return guarded([&]() {
+        cv::aruco::Dictionary dictionary = cv::aruco::getPredefinedDictionary(dictId);
+        canvas.setTo(cv::Scalar(255));
+
+        // Ids run from 0 row by row
+        int markerId = 0;
+        for (int row = 0; row < rows; row++) {
+            for (int col = 0; col < columns; col++) {
+                int x = col * (markerLength + separation) + separation / 2;
+                int y = row * (markerLength + separation) + separation / 2;
+                cv::Mat roi = canvas(cv::Rect(x, y, markerLength, markerLength));
+                cv::aruco::generateImageMarker(dictionary, markerId, markerLength, roi, 1);
+                markerId++;
+            }
+        }
+        return static_cast<int>(ARUCO_LAB_OK);
+    });
+}
+
+aruco_lab_detector* aruco_lab_detector_create(int dictId) {
+    if (!validDictionary(dictId)) {
+        return nullptr;
+    }
+    try {
+        cv::aruco::Dictionary dictionary = cv::aruco::getPredefinedDictionary(dictId);
+        cv::aruco::DetectorParameters detectorParams = cv::aruco::DetectorParameters();
+        return new aruco_lab_detector{cv::aruco::ArucoDetector(dictionary, detectorParams)};
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void aruco_lab_detector_destroy(aruco_lab_detector* detector) {
+    delete detector;
+}
+
+int aruco_lab_detect_markers(aruco_lab_detector* detector, const aruco_lab_image* image,
+                             int maxMarkers, int* ids, float* corners, int* nMarkers) {
+    cv::Mat frame;
+    if (detector == nullptr || !wrapImage(image, frame) || maxMarkers < 0 || nMarkers == nullptr) {
+        return ARUCO_LAB_ERR_INVALID_ARGUMENT;
+    }
+    if (maxMarkers > 0 && (ids == nullptr || corners == nullptr)) {
+        return ARUCO_LAB_ERR_INVALID_ARGUMENT;
+    }
+
+    // No stale results from a previous frame if detection fails
+    *nMarkers = 0;
+    return guarded([&]() {
+        vector<int> markerIds;
+        vector<vector<cv::Point2f>> markerCorners, rejectedCandidates;
+        detector->detector.detectMarkers(frame, markerCorners, markerIds, rejectedCandidates);
+
+        // Copy out as many as fit, report truncation
+        int n = min(static_cast<int>(markerIds.size()), maxMarkers);
+        for (int i = 0; i < n; i++) {
+            ids[i] = markerIds[i];
+            for (int k = 0; k < 4; k++) {
+                corners[8 * i + 2 * k] = markerCorners[i][k].x;
+                corners[8 * i + 2 * k + 1] = markerCorners[i][k].y;
+            }
+        }
+        *nMarkers = n;
+        return static_cast<int>(n < static_cast<int>(markerIds.size()) ? ARUCO_LAB_ERR_BUFFER_TOO_SMALL : ARUCO_LAB_OK);
+    });
+}
+
+int aruco_lab_calibrate_board(int dictId, int rows, int columns, double markerLength,
+                              double separation, int nFrames, const int* nMarkersPerFrame,
+                              const int* ids, const float* corners,
+                              int imageWidth, int imageHeight,
+                              aruco_lab_camera* camera, double* repError) {
+    if (!validDictionary(dictId)) {
+        return ARUCO_LAB_ERR_UNKNOWN_DICTIONARY;
+    }
+    if (rows <= 0 || columns <= 0 || markerLength <= 0 || separation < 0 || nFrames <= 0
+        || nMarkersPerFrame == nullptr || ids == nullptr || corners == nullptr
+        || imageWidth <= 0 || imageHeight <= 0 || camera == nullptr || repError == nullptr) {
+        return ARUCO_LAB_ERR_INVALID_ARGUMENT;
+    }
+    for (int frame = 0; frame < nFrames; frame++) {
+        if (nMarkersPerFrame[frame] < 0) {
+            return ARUCO_LAB_ERR_INVALID_ARGUMENT;
+        }
+    }
+    return guarded([&]() {
+        cv::aruco::Dictionary dictionary = cv::aruco::getPredefinedDictionary(dictId);
+        cv::aruco::GridBoard gridboard(cv::Size(columns, rows), static_cast<float>(markerLength),
+                                       static_cast<float>(separation), dictionary);
+
+        // Pre-process image points and object points for every frame
+        vector<cv::Mat> processedObjectPoints, processedImagePoints;
+        size_t offset = 0;
+        for (int frame = 0; frame < nFrames; frame++) {
+            int n = nMarkersPerFrame[frame];
+            vector<vector<cv::Point2f>> markerCorners;
+            unpackCorners(corners + 8 * offset, n, markerCorners);
+            vector<int> markerIds(ids + offset, ids + offset + n);
+            offset += n;
+
+            cv::Mat currentImgPoints, currentObjPoints;
+            gridboard.matchImagePoints(markerCorners, markerIds, currentObjPoints, currentImgPoints);
+            if (currentImgPoints.total() > 0 && currentObjPoints.total() > 0) {
+                processedImagePoints.push_back(currentImgPoints);
+                processedObjectPoints.push_back(currentObjPoints);
+            }
+        }
+        if (processedObjectPoints.empty()) {
+            return static_cast<int>(ARUCO_LAB_ERR_INVALID_ARGUMENT);
+        }
+
+        cv::Mat cameraMatrix = cv::Mat::eye(3, 3, CV_64F), distCoeffs;
+        vector<cv::Mat> rvecs, tvecs;
+        *repError = cv::calibrateCamera(processedObjectPoints, processedImagePoints, cv::Size(imageWidth, imageHeight),
+                                        cameraMatrix, distCoeffs, rvecs, tvecs);
+
+        cameraMatrix.copyTo(cameraMatrixOf(camera));
+        distCoeffs.reshape(1, 1).colRange(0, ARUCO_LAB_N_DIST_COEFFS).copyTo(distCoeffsOf(camera));
+        return static_cast<int>(ARUCO_LAB_OK);
+    });
+}
+
+aruco_lab_calibrator* aruco_lab_calibrator_create(int dictId, int rows, int columns,
+                                                  double markerLength, double separation,
+                                                  int imageWidth, int imageHeight) {
+    if (!validDictionary(dictId) || rows <= 0 || columns <= 0 || markerLength <= 0 || separation < 0
+        || imageWidth <= 0 || imageHeight <= 0) {
+        return nullptr;
+    }
+    try {
+        cv::aruco::Dictionary dictionary = cv::aruco::getPredefinedDictionary(dictId);
+        cv::aruco::GridBoard gridboard(cv::Size(columns, rows), static_cast<float>(markerLength),
+                                       static_cast<float>(separation), dictionary);
+        aruco_lab_calibrator* calibrator = new aruco_lab_calibrator(gridboard, cv::Size(imageWidth, imageHeight));
+        try {
+            calibrator->worker = thread(&aruco_lab_calibrator::run, calibrator);
+        } catch (...) {
+            delete calibrator;
+            return nullptr;
+        }
+        return calibrator;
+    } catch (...) {
+        return nullptr;
+    }
+}
+
+void aruco_lab_calibrator_destroy(aruco_lab_calibrator* calibrator) {
+    if (calibrator == nullptr) {
+        return;
+    }
+    {
+        lock_guard<mutex> guard(calibrator->stateMutex);
+        calibrator->stop = true;
+    }
+    calibrator->wake.notify_all();
+    calibrator->worker.join();
+    delete calibrator;
+}
+
+int aruco_lab_calibrator_add_view(aruco_lab_calibrator* calibrator, int nMarkers,
+                                  const int* ids, const float* corners) {
+    if (calibrator == nullptr || nMarkers < 0 || (nMarkers > 0 && (ids == nullptr || corners == nullptr))) {
+        return ARUCO_LAB_ERR_INVALID_ARGUMENT;
+    }
+    return guarded([&]() {
+        aruco_lab_calibrator::View view;
+        view.ids.assign(ids, ids + nMarkers);
+        unpackCorners(corners, nMarkers, view.corners);
+        {
+            lock_guard<mutex> guard(calibrator->stateMutex);
+            calibrator->pending.push_back(std::move(view));
+        }
+        calibrator->wake.notify_one();
+        return static_cast<int>(ARUCO_LAB_OK);
+    });
+}
+
+int aruco_lab_calibrator_estimate(aruco_lab_calibrator* calibrator, aruco_lab_calibration* estimate) {
+    if (calibrator == nullptr || estimate == nullptr) {
+        return ARUCO_LAB_ERR_INVALID_ARGUMENT;
+    }
+    lock_guard<mutex> guard(calibrator->stateMutex);
+    if (!calibrator->hasEstimate) {
+        return ARUCO_LAB_ERR_NOT_READY;
+    }
+    *estimate = calibrator->estimate;
+    return ARUCO_LAB_OK;
+}
+
+int aruco_lab_calibrator_finish(aruco_lab_calibrator* calibrator, aruco_lab_calibration* estimate) {
+    if (calibrator == nullptr || estimate == nullptr) {
+        return ARUCO_LAB_ERR_INVALID_ARGUMENT;
+    }
+
+    // Wait for the worker to drain the queue, then claim the views like it does
+    unique_lock<mutex> guard(calibrator->stateMutex);
+    calibrator->idle.wait(guard, [calibrator]() { return calibrator->pending.empty() && !calibrator->busy; });
+    if (calibrator->objectPoints.empty()) {
+        return ARUCO_LAB_ERR_NOT_READY;
+    }
+    calibrator->busy = true;
+    guard.unlock();
+
+    // Final solve over every view to full precision, warm-started from the
+    // live estimate; estimate and add_view stay responsive meanwhile
+    aruco_lab_calibration result = {};
+    const cv::TermCriteria fullCriteria(cv::TermCriteria::COUNT + cv::TermCriteria::EPS, 30, DBL_EPSILON);
+    bool solved = calibrator->solve(calibrator->objectPoints, calibrator->imagePoints, fullCriteria, result);
+
+    guard.lock();
+    if (solved) {
+        calibrator->publish(result);
+    }
+    calibrator->busy = false;
+    calibrator->idle.notify_all();
+    calibrator->wake.notify_one(); // views added during the solve
+
+    if (!calibrator->hasEstimate) {
+        return ARUCO_LAB_ERR_INTERNAL;
+    }
+    *estimate = calibrator->estimate;
+    return ARUCO_LAB_OK;
+}
+
+int aruco_lab_camera_load(const char* filename, aruco_lab_camera* camera) {
+    if (filename == nullptr || camera == nullptr) {
+        return ARUCO_LAB_ERR_INVALID_ARGUMENT;
+    }
+    return guarded([&]() {
+        cv::FileStorage fs(filename, cv::FileStorage::READ);
+        if (!fs.isOpened()) {
+            return static_cast<int>(ARUCO_LAB_ERR_IO);
+        }
+        cv::Mat cameraMatrix, distCoeffs;
+        fs["cameraMatrix"] >> cameraMatrix;
+        fs["distCoeffs"] >> distCoeffs;
+        fs.release();
+        if (cameraMatrix.total() != 9) {
+            return static_cast<int>(ARUCO_LAB_ERR_IO);
+        }
+
+        cameraMatrix.convertTo(cameraMatrixOf(camera), CV_64F);
+
+        // Missing trailing coefficients are treated as zero
+        fill(camera->distCoeffs, camera->distCoeffs + ARUCO_LAB_N_DIST_COEFFS, 0.0);
+        if (!distCoeffs.empty()) {
+            cv::Mat coeffs;
+            distCoeffs.reshape(1, 1).convertTo(coeffs, CV_64F);
+            int n = min(coeffs.cols, ARUCO_LAB_N_DIST_COEFFS);
+            copy(coeffs.ptr<double>(0), coeffs.ptr<double>(0) + n, camera->distCoeffs);
+        }
+        return static_cast<int>(ARUCO_LAB_OK);
+    });
+}
+
+int aruco_lab_camera_save(const char* filename, const aruco_lab_camera* camera, double repError) {
+    if (filename == nullptr || camera == nullptr) {
+        return ARUCO_LAB_ERR_INVALID_ARGUMENT;
+    }
+    return guarded([&]() {
+        cv::FileStorage fs(filename, cv::FileStorage::WRITE);
+        if (!fs.isOpened()) {
+            return static_cast<int>(ARUCO_LAB_ERR_IO);
+        }
+        fs << "cameraMatrix" << cameraMatrixOf(camera);
+        fs << "distCoeffs" << distCoeffsOf(camera);
+        fs << "repError" << repError;
+        fs.release();
+        return static_cast<int>(ARUCO_LAB_OK);
+    });
+}
+
+int aruco_lab_estimate_pose(const float* corners, double markerLength,
+                            const aruco_lab_camera* camera, double* rvec, double* tvec) {
+    if (corners == nullptr || markerLength <= 0 || camera == nullptr || rvec == nullptr || tvec == nullptr) {
+        return ARUCO_LAB_ERR_INVALID_ARGUMENT;
+    }
+    return guarded([&]() {
+        cv::Mat imgPoints(4, 1, CV_32FC2, const_cast<float*>(corners));
+        cv::Mat rvecMat(3, 1, CV_64F, rvec), tvecMat(3, 1, CV_64F, tvec);
+        bool solved = cv::solvePnP(markerObjectPoints(markerLength), imgPoints, cameraMatrixOf(camera),
+                                   distCoeffsOf(camera), rvecMat, tvecMat);
+        return static_cast<int>(solved ? ARUCO_LAB_OK : ARUCO_LAB_ERR_NO_SOLUTION);
+    });
+}
+
+int aruco_lab_draw_markers(aruco_lab_image* image, int nMarkers, const int* ids, const float* corners) {
+    cv::Mat frame;
+    if (!wrapImage(image, frame) || nMarkers < 0 || (nMarkers > 0 && (ids == nullptr || corners == nullptr))) {
+        return ARUCO_LAB_ERR_INVALID_ARGUMENT;
+    }
+    if (nMarkers == 0) {
+        return ARUCO_LAB_OK;
+    }
+    return guarded([&]() {
+        // Same look as cv::aruco::drawDetectedMarkers, but all outlines and
+        // all first-corner boxes go out in one cv::polylines call each
+        vector<vector<cv::Point>> outlines, cornerBoxes;
+        outlines.reserve(nMarkers);
+        cornerBoxes.reserve(nMarkers);
+        for (int i = 0; i < nMarkers; i++) {
+            const cv::Point2f* pts = reinterpret_cast<const cv::Point2f*>(corners + 8 * i);
+            outlines.push_back({cv::Point(pts[0]), cv::Point(pts[1]), cv::Point(pts[2]), cv::Point(pts[3])});
+
+            cv::Point tl(pts[0] - cv::Point2f(3, 3)), br(pts[0] + cv::Point2f(3, 3));
+            cornerBoxes.push_back({tl, cv::Point(br.x, tl.y), br, cv::Point(tl.x, br.y)});
+        }
+        cv::polylines(frame, outlines, true, cv::Scalar(0, 255, 0), 1);
+        cv::polylines(frame, cornerBoxes, true, cv::Scalar(0, 0, 255), 1, cv::LINE_AA);
+
+        // Ids at the marker centres
+        for (int i = 0; i < nMarkers; i++) {
+            const cv::Point2f* pts = reinterpret_cast<const cv::Point2f*>(corners + 8 * i);
+            cv::Point2f centre = (pts[0] + pts[1] + pts[2] + pts[3]) * 0.25f;
+            cv::putText(frame, "id=" + to_string(ids[i]), centre, cv::FONT_HERSHEY_SIMPLEX, 0.5, cv::Scalar(255, 0, 0), 2);
+        }
+        return static_cast<int>(ARUCO_LAB_OK);
+    });
+}
+
+int aruco_lab_draw_axes(aruco_lab_image* image, const aruco_lab_camera* camera,
+                        const double* rvec, const double* tvec, double length) {
+    return aruco_lab_draw_axes_batch(image, camera, 1, rvec, tvec, length);
+}
+
+int aruco_lab_draw_axes_batch(aruco_lab_image* image, const aruco_lab_camera* camera, int nAxes,
+                              const double* rvecs, const double* tvecs, double length) {
+    cv::Mat frame;
+    if (!wrapImage(image, frame) || camera == nullptr || nAxes < 0 || length <= 0
+        || (nAxes > 0 && (rvecs == nullptr || tvecs == nullptr))) {
+        return ARUCO_LAB_ERR_INVALID_ARGUMENT;
+    }
+    if (nAxes == 0) {
+        return ARUCO_LAB_OK;
+    }
+    return guarded([&]() {
+        // Origin and the tips of the X, Y and Z axes
+        float l = static_cast<float>(length);
+        vector<cv::Point3f> axisPoints = {
+            cv::Point3f(0, 0, 0), cv::Point3f(l, 0, 0), cv::Point3f(0, l, 0), cv::Point3f(0, 0, l)
+        };
+
+        // One polyline list per axis colour, shared by all poses
+        vector<vector<cv::Point>> axes[3];
+        vector<cv::Point2f> imagePoints;
+        for (int n = 0; n < nAxes; n++) {
+            cv::Mat rvecMat(3, 1, CV_64F, const_cast<double*>(rvecs + 3 * n));
+            cv::Mat tvecMat(3, 1, CV_64F, const_cast<double*>(tvecs + 3 * n));
+            cv::projectPoints(axisPoints, rvecMat, tvecMat, cameraMatrixOf(camera), distCoeffsOf(camera), imagePoints);
+            for (int a = 0; a < 3; a++) {
+                axes[a].push_back({cv::Point(imagePoints[0]), cv::Point(imagePoints[a + 1])});
+            }
+        }
+
+        // Same colours and thickness as cv::drawFrameAxes (X red, Y green, Z blue)
+        static const cv::Scalar colours[3] = {cv::Scalar(0, 0, 255), cv::Scalar(0, 255, 0), cv::Scalar(255, 0, 0)};
+        int lineThickness = 3;
+        for (int a = 0; a < 3; a++) {
+            cv::polylines(frame, axes[a], false, colours[a], lineThickness);
+        }
+        return static_cast<int>(ARUCO_LAB_OK);
+    });
+}
+
+int aruco_lab_draw_cube(aruco_lab_image* image, const aruco_lab_camera* camera,
+                        const double* rvec, const double* tvec, double markerLength) {
+    return aruco_lab_draw_cubes(image, camera, 1, rvec, tvec, markerLength);
+}
+
+int aruco_lab_draw_cubes(aruco_lab_image* image, const aruco_lab_camera* camera, int nCubes,
+                         const double* rvecs, const double* tvecs, double markerLength) {
+    cv::Mat frame;
+    if (!wrapImage(image, frame) || camera == nullptr || nCubes < 0 || markerLength <= 0
+        || (nCubes > 0 && (rvecs == nullptr || tvecs == nullptr))) {
+        return ARUCO_LAB_ERR_INVALID_ARGUMENT;
+    }
+    if (nCubes == 0) {
+        return ARUCO_LAB_OK;
+    }
+    return guarded([&]() {
+        // Cube vertices: top face (z = markerLength) then base on the marker
+        float half = static_cast<float>(markerLength / 2.0);
+        float height = static_cast<float>(markerLength);
+        vector<cv::Point3f> cubePoints = {
+            cv::Point3f(half, half, height), cv::Point3f(half, -half, height),
+            cv::Point3f(-half, -half, height), cv::Point3f(-half, half, height),
+            cv::Point3f(half, half, 0), cv::Point3f(half, -half, 0),
+            cv::Point3f(-half, -half, 0), cv::Point3f(-half, half, 0)
+        };
+
+        // Edges as polylines: top face, base (both closed) and the four
+        // vertical edges, collected for all cubes and drawn in one call
+        static const int faces[2][4] = {{0, 1, 2, 3}, {4, 5, 6, 7}};
+        vector<vector<cv::Point>> polylines;
+        polylines.reserve(6 * nCubes);
+        vector<cv::Point2f> imagePoints;
+        for (int n = 0; n < nCubes; n++) {
+            // Project cube vertices onto the image plane
+            cv::Mat rvecMat(3, 1, CV_64F, const_cast<double*>(rvecs + 3 * n));
+            cv::Mat tvecMat(3, 1, CV_64F, const_cast<double*>(tvecs + 3 * n));
+            cv::projectPoints(cubePoints, rvecMat, tvecMat, cameraMatrixOf(camera), distCoeffsOf(camera), imagePoints);
+
+            for (const auto& face : faces) {
+                vector<cv::Point> loop;
+                for (int v : face) {
+                    loop.push_back(imagePoints[v]);
+                }
+                loop.push_back(imagePoints[face[0]]);
+                polylines.push_back(loop);
+            }
+            for (int v = 0; v < 4; v++) {
+                polylines.push_back({cv::Point(imagePoints[v]), cv::Point(imagePoints[v + 4])});
+            }
+        }
+
+        int lineThickness = 4;
+        cv::polylines(frame, polylines, false, cv::Scalar(255, 0, 0), lineThickness);
+        return static_cast<int>(ARUCO_LAB_OK);
+    });
+}
+
+} // extern "C"
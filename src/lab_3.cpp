@@ -1,10 +1,9 @@
 #include "opencv2/highgui.hpp"
-#include "opencv2/imgproc.hpp"
-#include "opencv2/aruco.hpp"
+#include "aruco_lab_cv.hpp"
+#include "renderer.hpp"
 #include <iostream>
 #include <string>
 #include <vector>
-#include <unordered_map>
 
 using namespace std;
 
@@ -13,67 +12,58 @@ int main(int argc, char* argv[]) {
     // Parse inputs
     string dictName = argv[1]; // dictionary
 
-    // Map dictionary names to their corresponding enum values
-    unordered_map<string, int> dictMap = {
-        {"DICT_4X4_50", cv::aruco::DICT_4X4_50},
-        {"DICT_4X4_100", cv::aruco::DICT_4X4_100},
-        {"DICT_4X4_250", cv::aruco::DICT_4X4_250},
-        {"DICT_4X4_1000", cv::aruco::DICT_4X4_1000},
-        {"DICT_5X5_50", cv::aruco::DICT_5X5_50},
-        {"DICT_5X5_100", cv::aruco::DICT_5X5_100},
-        {"DICT_5X5_250", cv::aruco::DICT_5X5_250},
-        {"DICT_5X5_1000", cv::aruco::DICT_5X5_1000},
-        {"DICT_6X6_50", cv::aruco::DICT_6X6_50},
-        {"DICT_6X6_100", cv::aruco::DICT_6X6_100},
-        {"DICT_6X6_250", cv::aruco::DICT_6X6_250},
-        {"DICT_6X6_1000", cv::aruco::DICT_6X6_1000},
-        {"DICT_7X7_50", cv::aruco::DICT_7X7_50},
-        {"DICT_7X7_100", cv::aruco::DICT_7X7_100},
-        {"DICT_7X7_250", cv::aruco::DICT_7X7_250},
-        {"DICT_7X7_1000", cv::aruco::DICT_7X7_1000},
-        {"DICT_ARUCO_ORIGINAL", cv::aruco::DICT_ARUCO_ORIGINAL}
-    };
-
     // Use Aruco marker
-    cv::aruco::Dictionary dictionary;
-
-    auto it = dictMap.find(dictName);
-    if (it != dictMap.end()) {
-        dictionary = cv::aruco::getPredefinedDictionary(it->second);
-    } else {
+    int dictId;
+    if (aruco_lab_dictionary_from_name(dictName.c_str(), &dictId) != ARUCO_LAB_OK) {
         cerr << "Unknown dictionary name\n";
         return 1;
     }
 
+    // Create the detector once and reuse it for every frame
+    aruco_lab_detector* detector = aruco_lab_detector_create(dictId);
+    if (detector == nullptr) {
+        cerr << "Error: Unable to create detector." << endl;
+        return 1;
+    }
+
     // Open the default camera
-    cv::VideoCapture cap(0); 
+    cv::VideoCapture cap(0);
     if (!cap.isOpened()) {
         cerr << "Error: Unable to open camera." << endl;
+        aruco_lab_detector_destroy(detector);
         return -1;
     }
-    // Capture frames
-    cv::Mat frame;
-    while (cap.read(frame)) {
-        if (frame.empty()) {
-            cerr << "Error: Unable to read frame from camera." << endl;
-            break;
-        }
+
+    // Detection results (8 corner coordinates per marker)
+    const int maxMarkers = 256;
+    vector<int> markerIds(maxMarkers);
+    vector<float> markerCorners(8 * maxMarkers);
+    int nMarkers = 0;
+
+    // Detect on the capture thread, display until ESC is pressed
+    Renderer renderer("Output Window");
+    renderer.runWith(cap, [&](cv::Mat& frame) -> RenderFrame {
+        RenderFrame out;
+        out.image = frame;
 
         // Marker Detection
-        std::vector<int> markerIds;
-        std::vector<std::vector<cv::Point2f>> markerCorners, rejectedCandidates;
-        cv::aruco::DetectorParameters detectorParams = cv::aruco::DetectorParameters();
-        cv::aruco::ArucoDetector detector(dictionary, detectorParams);
-        detector.detectMarkers(frame, markerCorners, markerIds, rejectedCandidates);
-        
-        //Overlay Markers
-        cv::aruco::drawDetectedMarkers(frame, markerCorners, markerIds);
+        aruco_lab_image image = aruco_lab_wrap(frame);
+        int status = aruco_lab_detect_markers(detector, &image, maxMarkers, markerIds.data(), markerCorners.data(), &nMarkers);
+        if (status != ARUCO_LAB_OK && status != ARUCO_LAB_ERR_BUFFER_TOO_SMALL) {
+            cerr << "Error: Marker detection failed." << endl;
+            return out;
+        }
 
-        // Display Output
-        cv::imshow("Output Window", frame); // Display output frame
-        if (cv::waitKey(1) == 27) // Exit when ESC is pressed
-            break;
-    }
+        //Overlay Markers
+        vector<int> ids(markerIds.begin(), markerIds.begin() + nMarkers);
+        vector<float> corners(markerCorners.begin(), markerCorners.begin() + 8 * nMarkers);
+        out.overlay = [ids, corners](cv::Mat& canvas) {
+            aruco_lab_image overlay = aruco_lab_wrap(canvas);
+            aruco_lab_draw_markers(&overlay, static_cast<int>(ids.size()), ids.data(), corners.data());
+        };
+        return out;
+    });
 
+    aruco_lab_detector_destroy(detector);
     return 0;
 }
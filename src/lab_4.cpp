@@ -1,11 +1,9 @@
 #include "opencv2/highgui.hpp"
 #include "opencv2/imgproc.hpp"
-#include "opencv2/aruco.hpp"
-#include "opencv2/calib3d.hpp"
+#include "aruco_lab_cv.hpp"
 #include <iostream>
 #include <string>
 #include <vector>
-#include <unordered_map>
 
 using namespace std;
 
@@ -19,47 +17,37 @@ int main(int argc, char* argv[]) {
     double markerLength = atof(argv[5]); // side length of a single marker in meters
     double distance = atof(argv[6]); // distance between markers in meters
     string cameraFilename = argv[7]; // name of the calibration parameters file (yaml)
-
-    // Map dictionary names to their corresponding enum values
-    unordered_map<string, int> dictMap = {
-        {"DICT_4X4_50", cv::aruco::DICT_4X4_50},
-        {"DICT_4X4_100", cv::aruco::DICT_4X4_100},
-        {"DICT_4X4_250", cv::aruco::DICT_4X4_250},
-        {"DICT_4X4_1000", cv::aruco::DICT_4X4_1000},
-        {"DICT_5X5_50", cv::aruco::DICT_5X5_50},
-        {"DICT_5X5_100", cv::aruco::DICT_5X5_100},
-        {"DICT_5X5_250", cv::aruco::DICT_5X5_250},
-        {"DICT_5X5_1000", cv::aruco::DICT_5X5_1000},
-        {"DICT_6X6_50", cv::aruco::DICT_6X6_50},
-        {"DICT_6X6_100", cv::aruco::DICT_6X6_100},
-        {"DICT_6X6_250", cv::aruco::DICT_6X6_250},
-        {"DICT_6X6_1000", cv::aruco::DICT_6X6_1000},
-        {"DICT_7X7_50", cv::aruco::DICT_7X7_50},
-        {"DICT_7X7_100", cv::aruco::DICT_7X7_100},
-        {"DICT_7X7_250", cv::aruco::DICT_7X7_250},
-        {"DICT_7X7_1000", cv::aruco::DICT_7X7_1000},
-        {"DICT_ARUCO_ORIGINAL", cv::aruco::DICT_ARUCO_ORIGINAL}
-    };
+    bool incremental = argc > 8 && string(argv[8]) == "incremental"; // calibrate in the background while capturing
 
     // Use Aruco marker dictionary
-    cv::aruco::Dictionary dictionary;
-    
-    auto it = dictMap.find(dictName);
-    if (it != dictMap.end()) {
-        dictionary = cv::aruco::getPredefinedDictionary(it->second);
-    } else {
+    int dictId;
+    if (aruco_lab_dictionary_from_name(dictName.c_str(), &dictId) != ARUCO_LAB_OK) {
         cerr << "Unknown dictionary name\n";
         return 1;
     }
 
-    // Vector to store detected marker corners and ids for each image
-    vector<vector<vector<cv::Point2f>>> allMarkerCorners;
-    vector<vector<int>> allMarkerIds;
+    // Create the detector once (default detector parameters)
+    aruco_lab_detector* detector = aruco_lab_detector_create(dictId);
+    if (detector == nullptr) {
+        cerr << "Error: Unable to create detector." << endl;
+        return 1;
+    }
+
+    // Detected marker corners and ids of all captured images, back to back
+    vector<int> allMarkerIds;
+    vector<float> allMarkerCorners;
+    vector<int> nMarkersPerImage;
+
+    // Background calibrator (incremental mode), created once the frame size is known
+    aruco_lab_calibrator* calibrator = nullptr;
+    aruco_lab_calibration liveEstimate;
+    int shownViews = 0;
 
     // Open the default camera
-    cv::VideoCapture webCam(0); 
+    cv::VideoCapture webCam(0);
     if (!webCam.isOpened()) {
         cerr << "Error: Unable to open camera." << endl;
+        aruco_lab_detector_destroy(detector);
         return -1;
     }
 
@@ -68,11 +56,14 @@ int main(int argc, char* argv[]) {
     char keyPressed = 0; // Initialize key pressed variable
     int imgId = 0; // Initialize variable to store the number of images captured
 
-    // Vector to store image points for each image
-    vector<vector<cv::Point2f>> imagePointsPerImage;
+    // Detection results of the current frame (8 corner coordinates per marker)
+    const int maxMarkers = 256;
+    vector<int> markerIds(maxMarkers);
+    vector<float> markerCorners(8 * maxMarkers);
+    int nMarkers = 0;
+
+    while (webCam.isOpened()) {
 
-    while (webCam.isOpened()) { 
-                
         // Capture frames
         while (webCam.read(frame)) {
             if (frame.empty()) {
@@ -85,17 +76,26 @@ int main(int argc, char* argv[]) {
 
 
             // Marker Detection
-            std::vector<int> markerIds;
-            std::vector<std::vector<cv::Point2f>> markerCorners, rejectedCandidates;
-            cv::aruco::DetectorParameters detectorParams;
-            if (detectorFile == "None"){
-                detectorParams = cv::aruco::DetectorParameters(); // Use default detector parameter if not specified
-            }
-            cv::aruco::ArucoDetector detector(dictionary, detectorParams);
-            detector.detectMarkers(frame, markerCorners, markerIds, rejectedCandidates);
-            
+            aruco_lab_image image = aruco_lab_wrap(frame);
+            int detectStatus = aruco_lab_detect_markers(detector, &image, maxMarkers, markerIds.data(), markerCorners.data(), &nMarkers);
+            bool detected = detectStatus == ARUCO_LAB_OK || detectStatus == ARUCO_LAB_ERR_BUFFER_TOO_SMALL;
+
             //Overlay Markers
-            cv::aruco::drawDetectedMarkers(frame, markerCorners, markerIds);
+            aruco_lab_draw_markers(&image, nMarkers, markerIds.data(), markerCorners.data());
+
+            // Overlay the live calibration estimate
+            if (calibrator != nullptr && aruco_lab_calibrator_estimate(calibrator, &liveEstimate) == ARUCO_LAB_OK) {
+                string status = "Views: " + to_string(liveEstimate.nViews) + "  Error: " + to_string(liveEstimate.repError) + "px";
+                cv::putText(frame, status, cv::Point(10, 30), cv::FONT_HERSHEY_SIMPLEX, 0.8, cv::Scalar(0, 255, 0), 2);
+                if (liveEstimate.converged) {
+                    cv::putText(frame, "Converged, press ESC to finish", cv::Point(10, 60), cv::FONT_HERSHEY_SIMPLEX, 0.8, cv::Scalar(0, 255, 0), 2);
+                }
+                if (liveEstimate.nViews != shownViews) {
+                    shownViews = liveEstimate.nViews;
+                    cout << "Estimate from " << shownViews << " views. Reprojection error: " << liveEstimate.repError
+                         << (liveEstimate.converged ? " (converged)" : "") << endl;
+                }
+            }
 
 
             // Display Output
@@ -103,17 +103,31 @@ int main(int argc, char* argv[]) {
             cv::imshow("Output Window", frame); // Display output frame
             keyPressed = cv::waitKey(1);
 
-        
+
             // Capture the image when 'c' is pressed
-            if (keyPressed == 99) {
+            if (keyPressed == 99 && !detected) {
+                cerr << "Error: Marker detection failed, image not captured." << endl;
+            } else if (keyPressed == 99) {
                 // Save marker image to PNG
                 imgId++;
                 string imgFilename = "image" + to_string(imgId) + ".png";
                 cv::imwrite(imgFilename, frameWithoutOverlay);
-                
+
+                // Hand the view to the background calibrator
+                if (incremental) {
+                    if (calibrator == nullptr) {
+                        calibrator = aruco_lab_calibrator_create(dictId, rows, columns, markerLength, distance,
+                                                                 frameWithoutOverlay.cols, frameWithoutOverlay.rows);
+                    }
+                    if (calibrator != nullptr) {
+                        aruco_lab_calibrator_add_view(calibrator, nMarkers, markerIds.data(), markerCorners.data());
+                    }
+                }
+
                 // Store detected marker corners and ids
-                allMarkerCorners.push_back(markerCorners);
-                allMarkerIds.push_back(markerIds);
+                allMarkerIds.insert(allMarkerIds.end(), markerIds.begin(), markerIds.begin() + nMarkers);
+                allMarkerCorners.insert(allMarkerCorners.end(), markerCorners.begin(), markerCorners.begin() + 8 * nMarkers);
+                nMarkersPerImage.push_back(nMarkers);
                 cout << "Image " << imgId << " saved." << endl;
             }
 
@@ -132,49 +146,42 @@ int main(int argc, char* argv[]) {
     // Close camera
     webCam.release();
     cv::destroyAllWindows();
-
-    // Prepare data for calibration
-    vector<cv::Point3f> objectPoints;
-    vector<cv::Point2f> imagePoints;
-    vector<cv::Mat> processedObjectPoints, processedImagePoints;
-    size_t nFrames = allMarkerCorners.size();
-
-    // Create board object
-    cv::aruco::GridBoard gridboard(cv::Size(columns, rows), markerLength, distance, dictionary);
-
-    // Pre-process image points and object points for every frame
-    for(size_t frame = 0; frame < nFrames; frame++) {
-        cv::Mat currentImgPoints, currentObjPoints;
-
-        // Match object points with image points (using the gridboard)
-        gridboard.matchImagePoints(
-            allMarkerCorners[frame], allMarkerIds[frame],
-            currentObjPoints, currentImgPoints
-        );
-
-        // Store the pre-processed image points and object points
-        if(currentImgPoints.total() > 0 && currentObjPoints.total() > 0) {
-            processedImagePoints.push_back(currentImgPoints);
-            processedObjectPoints.push_back(currentObjPoints);
-        }
-    }
+    aruco_lab_detector_destroy(detector);
 
     // Perform camera calibration
     cv::Size imgSize = frameWithoutOverlay.size();
-    cv::Mat cameraMatrix = cv::Mat::eye(3, 3, CV_64F), distCoeffs;
-    std::vector<cv::Mat> rvecs, tvecs;
-
-    double repError = cv::calibrateCamera(processedObjectPoints, processedImagePoints, imgSize, cameraMatrix, distCoeffs, rvecs, tvecs);
+    aruco_lab_camera camera;
+    double repError = 0;
+    int status;
+
+    if (calibrator != nullptr) {
+        // Only the views still queued and one solve over all views remain
+        aruco_lab_calibration finalEstimate = {};
+        status = aruco_lab_calibrator_finish(calibrator, &finalEstimate);
+        aruco_lab_calibrator_destroy(calibrator);
+        if (status == ARUCO_LAB_OK) {
+            camera = finalEstimate.camera;
+            repError = finalEstimate.repError;
+        }
+    } else {
+        status = aruco_lab_calibrate_board(dictId, rows, columns, markerLength, distance,
+                                           static_cast<int>(nMarkersPerImage.size()), nMarkersPerImage.data(),
+                                           allMarkerIds.data(), allMarkerCorners.data(),
+                                           imgSize.width, imgSize.height, &camera, &repError);
+    }
+    if (status != ARUCO_LAB_OK) {
+        cerr << "Error: Calibration failed." << endl;
+        return 1;
+    }
 
     // Save calibration parameters
-    cv::FileStorage fs(cameraFilename, cv::FileStorage::WRITE);
-    fs << "cameraMatrix" << cameraMatrix;
-    fs << "distCoeffs" << distCoeffs;
-    fs << "repError" << repError;
-    fs.release();
+    if (aruco_lab_camera_save(cameraFilename.c_str(), &camera, repError) != ARUCO_LAB_OK) {
+        cerr << "Error: Couldn't write calibration file" << endl;
+        return 1;
+    }
 
     cout << "Calibration done. Reprojection error: " << repError << endl;
 
     return 0;
-    
-}
\ No newline at end of file
+
+}
@@ -1,11 +1,9 @@
 #include "opencv2/highgui.hpp"
-#include "opencv2/imgproc.hpp"
-#include "opencv2/aruco.hpp"
-#include "opencv2/calib3d.hpp"
+#include "aruco_lab_cv.hpp"
+#include "renderer.hpp"
 #include <iostream>
 #include <string>
 #include <vector>
-#include <unordered_map>
 
 using namespace std;
 
@@ -16,118 +14,93 @@ int main(int argc, char* argv[]) {
     int markerId = atoi(argv[2]); // id of the detected marker
     double markerLength = atof(argv[3]); // length of one side of the marker in meters
 
-    // Map dictionary names to their corresponding enum values
-    unordered_map<string, int> dictMap = {
-        {"DICT_4X4_50", cv::aruco::DICT_4X4_50},
-        {"DICT_4X4_100", cv::aruco::DICT_4X4_100},
-        {"DICT_4X4_250", cv::aruco::DICT_4X4_250},
-        {"DICT_4X4_1000", cv::aruco::DICT_4X4_1000},
-        {"DICT_5X5_50", cv::aruco::DICT_5X5_50},
-        {"DICT_5X5_100", cv::aruco::DICT_5X5_100},
-        {"DICT_5X5_250", cv::aruco::DICT_5X5_250},
-        {"DICT_5X5_1000", cv::aruco::DICT_5X5_1000},
-        {"DICT_6X6_50", cv::aruco::DICT_6X6_50},
-        {"DICT_6X6_100", cv::aruco::DICT_6X6_100},
-        {"DICT_6X6_250", cv::aruco::DICT_6X6_250},
-        {"DICT_6X6_1000", cv::aruco::DICT_6X6_1000},
-        {"DICT_7X7_50", cv::aruco::DICT_7X7_50},
-        {"DICT_7X7_100", cv::aruco::DICT_7X7_100},
-        {"DICT_7X7_250", cv::aruco::DICT_7X7_250},
-        {"DICT_7X7_1000", cv::aruco::DICT_7X7_1000},
-        {"DICT_ARUCO_ORIGINAL", cv::aruco::DICT_ARUCO_ORIGINAL}
-    };
-
     // Use Aruco marker dictionary
-    cv::aruco::Dictionary dictionary;   
-    auto it = dictMap.find(dictName);
-    if (it != dictMap.end()) {
-        dictionary = cv::aruco::getPredefinedDictionary(it->second);
-    } else {
+    int dictId;
+    if (aruco_lab_dictionary_from_name(dictName.c_str(), &dictId) != ARUCO_LAB_OK) {
         cerr << "Unknown dictionary name\n";
         return 1;
     }
 
     // Open the default camera
-    cv::VideoCapture webCam(0); 
+    cv::VideoCapture webCam(0);
     if (!webCam.isOpened()) {
         cerr << "Error: Unable to open camera." << endl;
         return 1;
     }
 
-    // Initialize frames
-    cv::Mat frame, frameCopy;
-
     // Export camera parameters
-    cv::FileStorage fs("../build/camera.yaml", cv::FileStorage::READ);
-    if (!fs.isOpened()) {
+    aruco_lab_camera camera;
+    if (aruco_lab_camera_load("../build/camera.yaml", &camera) != ARUCO_LAB_OK) {
         cerr << "Error: Couldn't open calibration file" << endl; // throws an error if the file can't be read
         return 1;
     }
 
-    cv::Mat cameraMatrix, distCoeffs;
-    fs["cameraMatrix"] >> cameraMatrix;
-    fs["distCoeffs"] >> distCoeffs;
-    fs.release();
+    // Create the detector once and reuse it for every frame
+    aruco_lab_detector* detector = aruco_lab_detector_create(dictId);
+    if (detector == nullptr) {
+        cerr << "Error: Unable to create detector." << endl;
+        return 1;
+    }
+
+    // Detection results (8 corner coordinates per marker)
+    const int maxMarkers = 256;
+    vector<int> markerIds(maxMarkers);
+    vector<float> markerCorners(8 * maxMarkers);
+    int nMarkers = 0;
 
-    // Loop while camera is capturing frame
-    while (webCam.read(frame)) {
-        if (frame.empty()) {
-            cerr << "Error: Unable to read frame from camera." << endl;
-            break;
-        }
+    // Coordinate labels, only used on the renderer's thread
+    TextCache text(cv::FONT_HERSHEY_SIMPLEX, 1, 2);
 
-        frame.copyTo(frameCopy);
+    // Detect on the capture thread, display until ESC is pressed
+    Renderer renderer("ArUco Marker Detection");
+    renderer.runWith(webCam, [&](cv::Mat& frame) -> RenderFrame {
+        RenderFrame out;
+        out.image = frame;
 
         // Marker Detection
-        std::vector<int> markerIds;
-        std::vector<std::vector<cv::Point2f>> markerCorners, rejectedCandidates;
-        cv::aruco::DetectorParameters detectorParams = cv::aruco::DetectorParameters();
-        cv::aruco::ArucoDetector detector(dictionary, detectorParams);
-        detector.detectMarkers(frame, markerCorners, markerIds, rejectedCandidates);
-    
-        // if at least one marker detected
-        if (markerIds.size() > 0){
-            // Draw the detector overlay
-            cv::aruco::drawDetectedMarkers(frameCopy, markerCorners, markerIds);
-
-            // Initialize transformation objects
-            size_t nMarkers = markerCorners.size();
-            vector<cv::Vec3d> rvecs(nMarkers), tvecs(nMarkers);
-
-            // set coordinate system
-            cv::Mat objPoints(4, 1, CV_32FC3);
-            objPoints.ptr<cv::Vec3f>(0)[0] = cv::Vec3f(-markerLength/2.f, markerLength/2.f, 0);
-            objPoints.ptr<cv::Vec3f>(0)[1] = cv::Vec3f(markerLength/2.f, markerLength/2.f, 0);
-            objPoints.ptr<cv::Vec3f>(0)[2] = cv::Vec3f(markerLength/2.f, -markerLength/2.f, 0);
-            objPoints.ptr<cv::Vec3f>(0)[3] = cv::Vec3f(-markerLength/2.f, -markerLength/2.f, 0);
-            
-            // Draw axis on the marker
-            for(int i=0; i < markerIds.size(); i++){
-                if (markerIds[i] == markerId) {
-                    // Estimate marker pose
-                    cv::solvePnP(objPoints, markerCorners.at(i), cameraMatrix, distCoeffs, rvecs.at(i), tvecs.at(i));
-
-                    // Draw axes
-                    cv::drawFrameAxes(frameCopy, cameraMatrix, distCoeffs, rvecs.at(i), tvecs.at(i), markerLength);
-
-                    // Display X component
-                    cv::putText(frameCopy, "X: " + std::to_string(tvecs[i](0)) + "m", cv::Point(10, 30), cv::FONT_HERSHEY_SIMPLEX, 1, cv::Scalar(0, 255, 0), 2);
-                    // Display Y component
-                    cv::putText(frameCopy, "Y: " + std::to_string(tvecs[i](1)) + "m", cv::Point(10, 60), cv::FONT_HERSHEY_SIMPLEX, 1, cv::Scalar(0, 255, 0), 2);
-                    // Display Z component
-                    cv::putText(frameCopy, "Z: " + std::to_string(tvecs[i](2)) + "m", cv::Point(10, 90), cv::FONT_HERSHEY_SIMPLEX, 1, cv::Scalar(0, 255, 0), 2);
+        aruco_lab_image image = aruco_lab_wrap(frame);
+        int status = aruco_lab_detect_markers(detector, &image, maxMarkers, markerIds.data(), markerCorners.data(), &nMarkers);
+        if (status != ARUCO_LAB_OK && status != ARUCO_LAB_ERR_BUFFER_TOO_SMALL) {
+            cerr << "Error: Marker detection failed." << endl;
+            return out;
+        }
 
+        // Estimate the pose of every matching marker
+        vector<int> ids(markerIds.begin(), markerIds.begin() + nMarkers);
+        vector<float> corners(markerCorners.begin(), markerCorners.begin() + 8 * nMarkers);
+        vector<double> rvecs, tvecs;
+        for(int i=0; i < nMarkers; i++){
+            if (markerIds[i] == markerId) {
+                double rvec[3], tvec[3];
+                if (aruco_lab_estimate_pose(&markerCorners[8 * i], markerLength, &camera, rvec, tvec) != ARUCO_LAB_OK) {
+                    continue; // no pose for this marker
                 }
+                rvecs.insert(rvecs.end(), rvec, rvec + 3);
+                tvecs.insert(tvecs.end(), tvec, tvec + 3);
             }
         }
 
-        cv::imshow("ArUco Marker Detection", frameCopy);
-        if (cv::waitKey(1) == 27) {
-            break;
-        }
-    }
+        // Overlay, drawn by the renderer only for frames it shows
+        out.overlay = [ids, corners, rvecs, tvecs, &camera, &text, markerLength](cv::Mat& canvas) {
+            aruco_lab_image overlay = aruco_lab_wrap(canvas);
+
+            // Draw the detector overlay and the axes of every matching marker
+            aruco_lab_draw_markers(&overlay, static_cast<int>(ids.size()), ids.data(), corners.data());
+            aruco_lab_draw_axes_batch(&overlay, &camera, static_cast<int>(tvecs.size() / 3),
+                                      rvecs.data(), tvecs.data(), markerLength);
+
+            // Display X, Y and Z components
+            for (size_t i = 0; i < tvecs.size(); i += 3) {
+                text.draw(canvas, "X: " + std::to_string(tvecs[i]) + "m", cv::Point(10, 30), cv::Scalar(0, 255, 0));
+                text.draw(canvas, "Y: " + std::to_string(tvecs[i + 1]) + "m", cv::Point(10, 60), cv::Scalar(0, 255, 0));
+                text.draw(canvas, "Z: " + std::to_string(tvecs[i + 2]) + "m", cv::Point(10, 90), cv::Scalar(0, 255, 0));
+            }
+        };
+        return out;
+    });
 
     webCam.release();
+    aruco_lab_detector_destroy(detector);
     return 0;
 
-}
\ No newline at end of file
+}
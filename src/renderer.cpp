@@ -0,0 +1,123 @@
+#include "renderer.hpp"
+#include "opencv2/highgui.hpp"
+#include "opencv2/imgproc.hpp"
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <thread>
+#include <utility>
+
+using namespace std;
+
+Renderer::Renderer(const string& windowName, double refreshRate)
+    : windowName(windowName),
+      periodMs(max(1, static_cast<int>(1000.0 / refreshRate))),
+      active(true) {}
+
+void Renderer::submit(RenderFrame frame) {
+    lock_guard<mutex> guard(latestMutex);
+    latest = std::move(frame); // replaces a frame that was never shown
+    hasLatest = true;
+}
+
+void Renderer::runWith(cv::VideoCapture& capture, const function<RenderFrame(cv::Mat&)>& process) {
+    thread producer([&]() {
+        cv::Mat frame;
+        while (running() && capture.read(frame)) {
+            if (frame.empty()) {
+                cerr << "Error: Unable to read frame from camera." << endl;
+                break;
+            }
+            submit(process(frame));
+            frame.release(); // the submitted frame keeps the buffer, read a fresh one
+        }
+        stop();
+    });
+
+    run();
+    producer.join();
+}
+
+void Renderer::run() {
+    cv::namedWindow(windowName, cv::WINDOW_AUTOSIZE);
+
+    while (active) {
+        auto deadline = chrono::steady_clock::now() + chrono::milliseconds(periodMs);
+
+        // Take the most recent frame, if any arrived since the last refresh
+        RenderFrame frame;
+        bool fresh = false;
+        {
+            lock_guard<mutex> guard(latestMutex);
+            if (hasLatest) {
+                frame = std::move(latest);
+                hasLatest = false;
+                fresh = true;
+            }
+        }
+
+        if (fresh && !frame.image.empty()) {
+            if (frame.overlay) {
+                frame.overlay(frame.image);
+            }
+            cv::imshow(windowName, frame.image);
+        }
+
+        // waitKey pumps window events and paces the loop until the next refresh
+        auto remaining = chrono::duration_cast<chrono::milliseconds>(deadline - chrono::steady_clock::now()).count();
+        if (cv::waitKey(max(1, static_cast<int>(remaining))) == 27) { // Exit when ESC is pressed
+            active = false;
+        }
+    }
+}
+
+void Renderer::stop() {
+    active = false;
+}
+
+bool Renderer::running() const {
+    return active;
+}
+
+TextCache::TextCache(int fontFace, double fontScale, int thickness)
+    : fontFace(fontFace), fontScale(fontScale), thickness(thickness) {}
+
+const TextCache::Glyph& TextCache::glyph(char c) {
+    auto it = glyphs.find(c);
+    if (it != glyphs.end()) {
+        return it->second;
+    }
+
+    // getTextSize adds the stroke thickness once per string, so the advance
+    // of a single character is the width difference between "cc" and "c"
+    int baseline = 0;
+    string one(1, c), two(2, c);
+    cv::Size size = cv::getTextSize(one, fontFace, fontScale, thickness, &baseline);
+    int advance = cv::getTextSize(two, fontFace, fontScale, thickness, &baseline).width - size.width;
+
+    // Rasterize with a margin so thick strokes are not clipped
+    Glyph g;
+    g.origin = cv::Point(thickness, thickness + size.height);
+    g.mask = cv::Mat::zeros(size.height + baseline + 2 * thickness, size.width + 2 * thickness, CV_8UC1);
+    cv::putText(g.mask, one, g.origin, fontFace, fontScale, cv::Scalar(255), thickness);
+    g.advance = advance;
+
+    return glyphs.emplace(c, g).first->second;
+}
+
+void TextCache::draw(cv::Mat& image, const string& text, cv::Point origin, const cv::Scalar& color) {
+    cv::Rect bounds(0, 0, image.cols, image.rows);
+    int x = origin.x;
+    for (char c : text) {
+        const Glyph& g = glyph(c);
+
+        // Copy the glyph colour through its mask, clipped to the image
+        cv::Rect target(x - g.origin.x, origin.y - g.origin.y, g.mask.cols, g.mask.rows);
+        cv::Rect visible = target & bounds;
+        if (visible.area() > 0) {
+            cv::Mat mask = g.mask(visible - target.tl());
+            image(visible).setTo(color, mask);
+        }
+        x += g.advance;
+    }
+}